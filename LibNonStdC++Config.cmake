@@ -1 +1,6 @@
+include(CMakeFindDependencyMacro)
+if(NOT WIN32)
+find_dependency(Threads)
+endif(NOT WIN32)
+
 include("${CMAKE_CURRENT_LIST_DIR}/LibNonStdC++Targets.cmake")
@@ -16,6 +16,7 @@
  *
  */
 
+#include "unicode/utf8.h"
 #include "unicode/utf16.h"
 
 void _c32toc8 ( uint_least32_t c, char* c8 ) {
@@ -27,31 +28,15 @@ void _c32toc8 ( uint_least32_t c, char* c8 ) {
         return;
     }
     static uint_least16_t lead = 0;
-    if (U16_IS_LEAD(c))
+    if (NONSTD_U16_IS_LEAD(c))
         lead = c;
-    if (U16_IS_TRAIL(c)) {
-        c = U16_GET_SUPPLEMENTARY(lead, c);
+    if (NONSTD_U16_IS_TRAIL(c)) {
+        c = NONSTD_U16_GET_SUPPLEMENTARY(lead, c);
         lead = 0;
     }
     if (lead) {
         c8[0] = '\0';
         return;
     }
-    int len;
-    if (c < 0x800)
-        len = 2;
-    else if (c < 0x10000)
-        len = 3;
-    else if (c < 0x200000)
-        len = 4;
-    else if (c < 0x4000000)
-        len = 5;
-    else
-        len = 6;
-    c8[len] = 0;
-    for (int i = len - 1; i >= 0; i--) {
-        c8[i] = 0x80 | (c & 0x3f);
-        c >>= 6;
-    }
-    c8[0] |= 0xff << (8 - len);
+    c8[nonstd_u8_encode(c, c8)] = '\0';
 }
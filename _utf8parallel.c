@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <string.h>
+#include "_utf8parallel.h"
+#include "stats.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* chunks smaller than this are not worth a thread */
+#define MIN_CHUNK_SIZE 0x10000
+#define MAX_THREADS 256
+
+struct chunk {
+    const char* begin;
+    const char* end;
+    void* dst;
+    size_t count;
+    int unit;
+    bool invalid;
+};
+
+/*
+ * Every byte that is not a continuation byte starts a code point,
+ * and 4-byte sequences need a surrogate pair in UTF-16; nonstd_u8_decode
+ * rejects overlong forms, so this matches what decode_chunk writes.
+ */
+static void* count_chunk ( void* arg ) {
+    struct chunk* chunk = arg;
+    size_t count = 0;
+    for (const char* p = chunk->begin; p < chunk->end; p++) {
+        count += !NONSTD_U8_IS_TRAIL(*p);
+        if (chunk->unit == 2)
+            count += (uint8_t)*p >= 0xf0;
+    }
+    chunk->count = count;
+    return NULL;
+}
+
+static void* decode_chunk ( void* arg ) {
+    struct chunk* chunk = arg;
+    const char* src = chunk->begin;
+    uint_least32_t* dst32 = chunk->dst;
+    uint_least16_t* dst16 = chunk->dst;
+    size_t i = 0;
+    while (src < chunk->end) {
+        uint_least32_t c;
+        uint8_t c8len = nonstd_u8_decode(src, chunk->end - src, &c);
+        if (!c8len) {
+            chunk->invalid = true;
+            return NULL;
+        }
+        src += c8len;
+        if (chunk->unit == 4)
+            dst32[i++] = c;
+        else
+            i += nonstd_u16_encode(c, dst16 + i);
+    }
+    chunk->count = i;
+    return NULL;
+}
+
+static void run_chunks ( void* (*fn)(void*), struct chunk* chunks, unsigned n ) {
+#ifndef _WIN32
+    pthread_t threads[MAX_THREADS];
+    unsigned started = 1;
+    for (; started < n; started++)
+        if (pthread_create(&threads[started], NULL, fn, &chunks[started]))
+            break;
+    for (unsigned i = started; i < n; i++)
+        fn(&chunks[i]);
+    fn(&chunks[0]);
+    for (unsigned i = 1; i < started; i++)
+        pthread_join(threads[i], NULL);
+#else
+    for (unsigned i = 0; i < n; i++)
+        fn(&chunks[i]);
+#endif
+}
+
+void* _utf8_parallel ( const char* src, void* dst, size_t size, unsigned threads, int unit ) {
+    if (!size)
+        size = strlen(src);
+    if (!threads) {
+#ifndef _WIN32
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = n > 0 ? n : 1;
+#else
+        threads = 1;
+#endif
+    }
+    if (threads > MAX_THREADS)
+        threads = MAX_THREADS;
+    if (threads > size / MIN_CHUNK_SIZE)
+        threads = size / MIN_CHUNK_SIZE ? size / MIN_CHUNK_SIZE : 1;
+
+    struct chunk chunks[MAX_THREADS];
+    const char* end = src + size;
+    for (unsigned i = 0; i < threads; i++) {
+        const char* begin = src + size / threads * i;
+        /* a chunk never starts in the middle of a code point */
+        while (begin < end && NONSTD_U8_IS_TRAIL(*begin))
+            begin++;
+        chunks[i].begin = i ? begin : src;
+        chunks[i].unit = unit;
+        chunks[i].invalid = false;
+        if (i)
+            chunks[i - 1].end = chunks[i].begin;
+    }
+    chunks[threads - 1].end = end;
+
+    bool alloc = !dst;
+    size_t len = 0;
+    if (threads == 1) {
+        /* no offsets to find, decode serially into a worst-case buffer */
+        if (alloc) {
+            dst = malloc(size * unit + unit);
+            NONSTD_STATS_ADD(allocations, 1);
+        }
+        if (!dst)
+            return NULL;
+        chunks[0].dst = dst;
+        decode_chunk(&chunks[0]);
+        len = chunks[0].count;
+    }
+    else {
+        run_chunks(count_chunk, chunks, threads);
+
+        for (unsigned i = 0; i < threads; i++)
+            len += chunks[i].count;
+        if (alloc) {
+            dst = malloc(len * unit + unit);
+            NONSTD_STATS_ADD(allocations, 1);
+        }
+        if (!dst)
+            return NULL;
+        size_t offset = 0;
+        for (unsigned i = 0; i < threads; offset += chunks[i++].count)
+            chunks[i].dst = (char*)dst + offset * unit;
+
+        run_chunks(decode_chunk, chunks, threads);
+    }
+
+    for (unsigned i = 0; i < threads; i++)
+        if (chunks[i].invalid) {
+            NONSTD_STATS_ADD(invalid_sequences, 1);
+            if (alloc)
+                free(dst);
+            return NULL;
+        }
+    NONSTD_STATS_ADD(bytes_decoded, size);
+    if (unit == 4)
+        ((uint_least32_t*)dst)[len] = 0;
+    else
+        ((uint_least16_t*)dst)[len] = 0;
+    if (alloc && threads == 1) {
+        dst = realloc(dst, len * unit + unit);
+        NONSTD_STATS_ADD(reallocations, 1);
+    }
+    return dst;
+}
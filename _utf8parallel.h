@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _NONSTD_UTF8PARALLEL_H
+#define _NONSTD_UTF8PARALLEL_H
+
+#include <stddef.h>
+
+/* shared by the utf8_to_utf*_parallel wrappers; unit is the output code unit size in bytes */
+void* _utf8_parallel ( const char* src, void* dst, size_t size, unsigned threads, int unit );
+
+#endif // _NONSTD_UTF8PARALLEL_H
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "basic_variant"
+
+#include <utility>
+#include <variant>
+#include <vector>
+
+template< int N >
+struct alternative {
+    int value;
+    bool operator== ( const alternative& other ) const { return value == other.value; }
+    bool operator< ( const alternative& other ) const { return value < other.value; }
+};
+
+template< typename Sequence >
+struct alternatives;
+
+template< int... N >
+struct alternatives<std::integer_sequence<int, N...>> {
+    using variant = non_std::basic_variant<alternative<N>...>;
+    using std_variant = std::variant<alternative<N>...>;
+};
+
+using many = alternatives<std::make_integer_sequence<int, 32>>;
+
+static const std::size_t count = 1 << 16;
+
+template< typename Variant >
+static std::vector<Variant> make_variants() {
+    std::vector<Variant> variants;
+    variants.reserve ( count );
+    unsigned seed = 1;
+    auto make = [&] ( auto self, auto index ) -> Variant {
+        constexpr int i = decltype(index)::value;
+        if constexpr ( i + 1 < 32 )
+            if ( int(seed >> 16) % 32 != i )
+                return self ( self, std::integral_constant<int, i + 1>{} );
+        return Variant ( alternative<i>{int(seed)} );
+    };
+    for ( std::size_t i = 0; i < count; i++ ) {
+        seed = seed * 1103515245 + 12345;
+        variants.push_back ( make ( make, std::integral_constant<int, 0>{} ) );
+    }
+    return variants;
+}
+
+static std::vector<many::variant>& variants() {
+    static auto v = make_variants<many::variant>();
+    return v;
+}
+
+struct sum_visitor {
+    long sum = 0;
+    template< typename Type >
+    void operator() ( Type* data ) { sum += data->value; }
+    void operator() ( std::nullptr_t ) {}
+};
+
+BENCHMARK("basic_variant/apply_visitor (32 alternatives)") {
+    sum_visitor visitor;
+    for ( auto&& v: variants() )
+        v.apply_visitor ( visitor );
+    bench::keep ( visitor.sum );
+    state.items = count;
+}
+
+BENCHMARK("basic_variant/is<T> (32 alternatives)") {
+    std::size_t n = 0;
+    for ( auto&& v: variants() )
+        n += v.is<alternative<17>>();
+    bench::keep ( n );
+    state.items = count;
+}
+
+BENCHMARK("basic_variant/copy (32 alternatives)") {
+    static std::vector<many::variant> copies ( count );
+    for ( std::size_t i = 0; i < count; i++ )
+        copies[i] = variants()[i];
+    bench::keep ( copies[0] );
+    state.items = count;
+}
+
+BENCHMARK("basic_variant/std::visit baseline (32 alternatives)") {
+    static auto std_variants = make_variants<many::std_variant>();
+    long sum = 0;
+    for ( auto&& v: std_variants )
+        sum += std::visit ( [] ( auto&& x ) { return x.value; }, v );
+    bench::keep ( sum );
+    state.items = count;
+}
@@ -0,0 +1,70 @@
+/*
+ * Benchmark harness
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NON_STD_BENCH_H
+#define NON_STD_BENCH_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace bench
+{
+
+/* filled in by a benchmark to describe the work done by one iteration */
+struct state {
+    std::size_t bytes = 0;
+    std::size_t items = 0;
+};
+
+using function = std::function<void ( state& )>;
+
+/*
+ * The first call of every benchmark is an untimed warm-up,
+ * so expensive fixtures can be built lazily in function statics.
+ */
+void add ( std::string name, function fn );
+
+struct registrar {
+    registrar ( std::string name, function fn ) { add ( std::move ( name ), std::move ( fn ) ); }
+};
+
+/* keep the compiler from optimizing away a computed value */
+template< typename Type >
+inline void keep ( const Type& value ) {
+#if defined __GNUC__ || defined __clang__
+    asm volatile ( "" : : "r,m" ( value ) : "memory" );
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/* path of a scratch file, removed when the program exits */
+std::string temp_file ( const std::string& name );
+}
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCHMARK(NAME) \
+    static void BENCH_CONCAT(bench_, __LINE__) ( bench::state& ); \
+    static bench::registrar BENCH_CONCAT(bench_registrar_, __LINE__) { NAME, BENCH_CONCAT(bench_, __LINE__) }; \
+    static void BENCH_CONCAT(bench_, __LINE__) ( bench::state& state )
+
+#endif // NON_STD_BENCH_H
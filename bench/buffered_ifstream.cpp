@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "buffered_ifstream"
+
+#include <fstream>
+#include <string>
+
+static const std::size_t file_size = 64 << 20;
+
+static const std::string& data_file() {
+    static std::string path = [] {
+        std::string path = bench::temp_file ( "buffered_ifstream" );
+        std::ofstream out ( path, std::ios::binary );
+        std::string block ( 1 << 16, '\0' );
+        unsigned seed = 1;
+        for ( std::size_t written = 0; written < file_size; written += block.size() ) {
+            for ( auto&& c: block ) {
+                seed = seed * 1103515245 + 12345;
+                c = ' ' + (seed >> 16) % 95;
+            }
+            out.write ( block.data(), block.size() );
+        }
+        return path;
+    }();
+    return path;
+}
+
+BENCHMARK("buffered_ifstream/get") {
+    non_std::buffered_ifstream in ( data_file() );
+    std::size_t n = 0;
+    unsigned sum = 0;
+    for ( auto c = in.get(); c != std::char_traits<char>::eof(); c = in.get() ) {
+        sum += c;
+        n++;
+    }
+    bench::keep ( sum );
+    state.bytes = n;
+    state.items = n;
+}
+
+BENCHMARK("buffered_ifstream/peek+get") {
+    non_std::buffered_ifstream in ( data_file() );
+    std::size_t n = 0;
+    unsigned sum = 0;
+    while ( in.peek() != std::char_traits<char>::eof() ) {
+        sum += in.get();
+        n++;
+    }
+    bench::keep ( sum );
+    state.bytes = n;
+    state.items = n;
+}
+
+BENCHMARK("buffered_ifstream/std::ifstream::get baseline") {
+    std::ifstream in ( data_file() );
+    std::size_t n = 0;
+    unsigned sum = 0;
+    for ( auto c = in.get(); c != std::char_traits<char>::eof(); c = in.get() ) {
+        sum += c;
+        n++;
+    }
+    bench::keep ( sum );
+    state.bytes = n;
+    state.items = n;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "char32.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* ASCII, Latin, Cyrillic, CJK and emoji, mixed */
+static const char* samples[] = {
+    "The quick brown fox jumps over the lazy dog. ",
+    "P\xc5\x99\xc3\xadli\xc5\xa1 \xc5\xbelu\xc5\xa5ou\xc4\x8dk\xc3\xbd k\xc5\xaf\xc5\x88. ",
+    "\xd0\xa1\xd1\x8a\xd0\xb5\xd1\x88\xd1\x8c \xd0\xb5\xd1\x89\xd1\x91 \xd1\x8d\xd1\x82\xd0\xb8\xd1\x85. ",
+    "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87\xe7\xab\xa0\xe3\x80\x82",
+    "\xf0\x9f\x98\x80\xf0\x9f\x8c\x8d\xf0\x9f\x9a\x80 ",
+};
+
+/* the non-native UTF-16 byte order */
+static int swapped_byte_order() {
+    const uint_least16_t bom = 0xfeff;
+    return *reinterpret_cast<const unsigned char*> ( &bom ) == 0xff ? UTF_BIG_ENDIAN : UTF_LITTLE_ENDIAN;
+}
+
+struct corpus {
+    std::string utf8;
+    std::size_t len;
+    std::vector<uint_least32_t> utf32;
+    std::vector<uint_least16_t> utf16;
+    std::size_t utf16_len;
+    std::vector<uint_least16_t> utf16_swapped;
+
+    explicit corpus ( std::size_t size ) {
+        utf8.reserve ( size + 64 );
+        unsigned seed = 1;
+        while ( utf8.size() < size ) {
+            seed = seed * 1103515245 + 12345;
+            utf8 += samples[(seed >> 16) % (sizeof(samples) / sizeof(*samples))];
+        }
+        len = utf8_strlen ( utf8.c_str() );
+        utf32.resize ( len + 1 );
+        utf8_to_utf32 ( utf8.c_str(), utf32.data(), len );
+        utf16.resize ( len * 2 + 1 );
+        utf8_to_utf16 ( utf8.c_str(), utf16.data(), len );
+        utf16_len = len + std::count_if ( utf32.begin(), utf32.end(), [] ( uint_least32_t c ) { return c > 0xffff; } );
+        utf16_swapped.resize ( len * 2 + 1 );
+        utf32_to_utf16 ( utf32.data(), utf16_swapped.data(), len, swapped_byte_order() );
+    }
+};
+
+static const corpus& text() {
+    static corpus c ( 32 << 20 );
+    return c;
+}
+
+static uint_least32_t* utf32_buffer() {
+    static std::vector<uint_least32_t> buffer ( text().len + 1 );
+    return buffer.data();
+}
+
+static uint_least16_t* utf16_buffer() {
+    static std::vector<uint_least16_t> buffer ( text().len * 2 + 1 );
+    return buffer.data();
+}
+
+static void check ( const void* p, const char* what ) {
+    if ( !p ) {
+        std::fprintf ( stderr, "%s failed on the benchmark corpus\n", what );
+        std::exit ( 1 );
+    }
+}
+
+static void verify ( const void* output, const void* expected, std::size_t size, const char* what ) {
+    if ( std::memcmp ( output, expected, size ) ) {
+        std::fprintf ( stderr, "%s output differs from the serial conversion\n", what );
+        std::exit ( 1 );
+    }
+}
+
+BENCHMARK("char32/utf8_strlen") {
+    bench::keep ( utf8_strlen ( text().utf8.c_str() ) );
+    state.bytes = text().utf8.size();
+    state.items = text().len;
+}
+
+BENCHMARK("char32/utf8_to_utf32") {
+    check ( utf8_to_utf32 ( text().utf8.c_str(), utf32_buffer(), text().len ), "utf8_to_utf32" );
+    state.bytes = text().utf8.size();
+    state.items = text().len;
+}
+
+BENCHMARK("char32/utf8_to_utf16") {
+    check ( utf8_to_utf16 ( text().utf8.c_str(), utf16_buffer(), text().len ), "utf8_to_utf16" );
+    state.bytes = text().utf8.size();
+    state.items = text().len;
+}
+
+BENCHMARK("char32/utf8_to_utf16 (allocating)") {
+    uint_least16_t* p = utf8_to_utf16 ( text().utf8.c_str(), nullptr, text().len );
+    check ( p, "utf8_to_utf16" );
+    std::free ( p );
+    state.bytes = text().utf8.size();
+    state.items = text().len;
+}
+
+/* the warm-up call checks the output against the serial conversion */
+static void parallel_utf32 ( bench::state& state, int threads, bool& verified ) {
+    if ( !verified )
+        std::memset ( utf32_buffer(), 0xff, text().len * sizeof ( uint_least32_t ) );
+    check ( utf8_to_utf32_parallel ( text().utf8.data(), utf32_buffer(), text().utf8.size(), threads ), "utf8_to_utf32_parallel" );
+    if ( !verified ) {
+        verify ( utf32_buffer(), text().utf32.data(), text().len * sizeof ( uint_least32_t ), "utf8_to_utf32_parallel" );
+        verified = true;
+    }
+    state.bytes = text().utf8.size();
+    state.items = text().len;
+}
+
+static void parallel_utf16 ( bench::state& state, int threads, bool& verified ) {
+    if ( !verified )
+        std::memset ( utf16_buffer(), 0xff, text().utf16_len * sizeof ( uint_least16_t ) );
+    check ( utf8_to_utf16_parallel ( text().utf8.data(), utf16_buffer(), text().utf8.size(), threads ), "utf8_to_utf16_parallel" );
+    if ( !verified ) {
+        verify ( utf16_buffer(), text().utf16.data(), text().utf16_len * sizeof ( uint_least16_t ), "utf8_to_utf16_parallel" );
+        verified = true;
+    }
+    state.bytes = text().utf8.size();
+    state.items = text().len;
+}
+
+static bench::registrar parallel_benchmarks[] = {
+#define PARALLEL(THREADS) \
+    { "char32/utf8_to_utf32_parallel/" #THREADS, [] ( bench::state& state ) { \
+        static bool verified = false; \
+        parallel_utf32 ( state, THREADS, verified ); \
+    } }, \
+    { "char32/utf8_to_utf16_parallel/" #THREADS, [] ( bench::state& state ) { \
+        static bool verified = false; \
+        parallel_utf16 ( state, THREADS, verified ); \
+    } }
+    PARALLEL(1), PARALLEL(2), PARALLEL(4), PARALLEL(8), PARALLEL(16)
+#undef PARALLEL
+};
+
+BENCHMARK("char32/utf16_to_utf32") {
+    check ( utf16_to_utf32 ( text().utf16.data(), utf32_buffer(), 0, UTF_NATIVE_ENDIAN ), "utf16_to_utf32" );
+    state.bytes = text().utf16_len * 2;
+    state.items = text().len;
+}
+
+BENCHMARK("char32/utf16_to_utf32 (byte swapped)") {
+    check ( utf16_to_utf32 ( text().utf16_swapped.data(), utf32_buffer(), 0,
+                             swapped_byte_order() ), "utf16_to_utf32" );
+    state.bytes = text().utf16_len * 2;
+    state.items = text().len;
+}
+
+BENCHMARK("char32/utf32_to_utf16") {
+    check ( utf32_to_utf16 ( text().utf32.data(), utf16_buffer(), text().len, UTF_NATIVE_ENDIAN ), "utf32_to_utf16" );
+    state.bytes = text().len * 4;
+    state.items = text().len;
+}
+
+BENCHMARK("char32/getc32") {
+    static std::string path = [] {
+        std::string path = bench::temp_file ( "getc32" );
+        FILE* f = std::fopen ( path.c_str(), "wb" );
+        std::fwrite ( text().utf8.data(), 1, 4 << 20, f );
+        std::fclose ( f );
+        return path;
+    }();
+    FILE* f = std::fopen ( path.c_str(), "rb" );
+    std::size_t n = 0;
+    while ( getc32 ( f ) != uint_least32_t ( -1 ) || !std::feof ( f ) )
+        n++;
+    std::fclose ( f );
+    state.bytes = 4 << 20;
+    state.items = n;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "cxxabi"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/* symbols exported by libstdc++ and libnonstdc++ itself */
+static const char* symbols[] = {
+    "_ZN7non_std8demangleB5cxx11EPKc",
+    "_ZN7non_std13mangle_symbolENSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEE",
+    "_ZN2dl4openEPKc",
+    "_ZN2dl5closeEPv",
+    "_ZN2dl3symEPvPKc",
+    "_ZN2dl5errorEv",
+    "_ZNSt8ios_base4InitC1Ev",
+    "_ZNSt8ios_base4InitD1Ev",
+    "_ZNSo3putEc",
+    "_ZNSo5flushEv",
+    "_ZNSi3getEv",
+    "_ZNSi4peekEv",
+    "_ZNSi8readsomeEPcl",
+    "_ZNKSt5ctypeIcE13_M_widen_initEv",
+    "_ZNSt6chrono3_V212steady_clock3nowEv",
+    "_ZSt20__throw_length_errorPKc",
+    "_ZSt24__throw_out_of_range_fmtPKcz",
+    "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE9_M_createERmm",
+    "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE10_M_replaceEmmPKcm",
+    "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE7reserveEm",
+    "_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE9_M_appendEPKcm",
+    "_ZNKSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE4findEPKcmm",
+    "_ZNKSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE5rfindEcm",
+    "_ZNKSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE17find_first_not_ofEPKcmm",
+    "_ZNSt13basic_filebufIcSt11char_traitsIcEE4openEPKcSt13_Ios_Openmode",
+    "_ZNSt14basic_ifstreamIcSt11char_traitsIcEEC1ERKNSt7__cxx1112basic_stringIcS1_SaIcEEESt13_Ios_Openmode",
+    "_ZNSt14basic_ifstreamIcSt11char_traitsIcEED1Ev",
+    "_ZSt16__ostream_insertIcSt11char_traitsIcEERSt13basic_ostreamIT_T0_ES6_PKS3_l",
+    "_ZSt4endlIcSt11char_traitsIcEERSt13basic_ostreamIT_T0_ES6_",
+    "_ZNSt6vectorINSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEESaIS5_EE17_M_realloc_insertIJRKS5_EEEvN9__gnu_cxx17__normal_iteratorIPS5_S7_EEDpOT_",
+    "_ZNSt6thread15_M_start_threadESt10unique_ptrINS_6_StateESt14default_deleteIS1_EEPFvvE",
+    "_ZNKSt9bad_alloc4whatEv",
+    "_ZNSt12__basic_fileIcED1Ev",
+    "_ZNSt9basic_iosIcSt11char_traitsIcEE5clearESt12_Ios_Iostate",
+};
+
+static const std::size_t count = sizeof ( symbols ) / sizeof ( *symbols );
+
+BENCHMARK("cxxabi/demangle") {
+    std::size_t length = 0;
+    for ( int round = 0; round < 100; round++ )
+        for ( auto symbol: symbols )
+            length += non_std::demangle ( symbol ).size();
+    bench::keep ( length );
+    state.items = 100 * count;
+}
+
+/*
+ * mangle_symbol knows neither const nor substitutions, so few demangled
+ * library symbols survive a round trip; these are names it does handle,
+ * with what g++ mangles them to
+ */
+static const struct {
+    const char* name;
+    const char* symbol;
+} functions[] = {
+    { "hash(long long,unsigned long long)", "_Z4hashxy" },
+    { "lerp(double,double,float)", "_Z4lerpddf" },
+    { "clamp(long double,signed char)", "_Z5clampea" },
+    { "widen(wchar_t,char16_t,char32_t)", "_Z5widenwDsDi" },
+    { "encode(short,char,long)", "_Z6encodescl" },
+    { "truncate(unsigned short,unsigned char)", "_Z8truncateth" },
+    { "set_flags(bool*,bool)", "_Z9set_flagsPbb" },
+    { "buffered_ifstream::get()", "_ZN17buffered_ifstream3getEv" },
+    { "buffered_ifstream::peek()", "_ZN17buffered_ifstream4peekEv" },
+    { "buffered_ifstream::read(char*,long)", "_ZN17buffered_ifstream4readEPcl" },
+    { "buffered_ifstream::close()", "_ZN17buffered_ifstream5closeEv" },
+    { "buffered_ifstream::seekg(long,int)", "_ZN17buffered_ifstream5seekgEli" },
+    { "buffered_ifstream::unget()", "_ZN17buffered_ifstream5ungetEv" },
+    { "buffered_ifstream::ignore(long,int)", "_ZN17buffered_ifstream6ignoreEli" },
+    { "dl::close(void*)", "_ZN2dl5closeEPv" },
+    { "dl::error()", "_ZN2dl5errorEv" },
+    { "gfx::image::png::flip()", "_ZN3gfx5image3png4flipEv" },
+    { "gfx::image::png::scale(float,float)", "_ZN3gfx5image3png5scaleEff" },
+    { "gfx::image::png::resize(int,int,double)", "_ZN3gfx5image3png6resizeEiid" },
+    { "net::socket::bind(int)", "_ZN3net6socket4bindEi" },
+    { "net::socket::recv(char*,long)", "_ZN3net6socket4recvEPcl" },
+    { "net::socket::listen(int)", "_ZN3net6socket6listenEi" },
+    { "net::socket::shutdown(bool)", "_ZN3net6socket8shutdownEb" },
+    { "bench::add(char*,int)", "_ZN5bench3addEPci" },
+    { "bench::keep(unsigned int)", "_ZN5bench4keepEj" },
+    { "bench::keep(unsigned long)", "_ZN5bench4keepEm" },
+    { "non_std::power(double,int)", "_ZN7non_std5powerEdi" },
+    { "non_std::power(float,long)", "_ZN7non_std5powerEfl" },
+    { "non_std::power(int,int)", "_ZN7non_std5powerEii" },
+    { "non_std::power(long,long)", "_ZN7non_std5powerEll" },
+};
+
+/* the warm-up call checks every name still mangles to its symbol */
+static void verify_mangling() {
+    for ( auto&& f: functions ) {
+        std::string symbol = non_std::mangle_symbol ( f.name );
+        if ( symbol != f.symbol ) {
+            std::fprintf ( stderr, "mangle_symbol(\"%s\") returned %s, expected %s\n", f.name, symbol.c_str(), f.symbol );
+            std::exit ( 1 );
+        }
+    }
+}
+
+BENCHMARK("cxxabi/mangle_symbol") {
+    static bool verified = false;
+    if ( !verified ) {
+        verify_mangling();
+        verified = true;
+    }
+    std::size_t length = 0;
+    for ( int round = 0; round < 100; round++ )
+        for ( auto&& f: functions )
+            length += non_std::mangle_symbol ( f.name ).size();
+    bench::keep ( length );
+    state.items = 100 * sizeof ( functions ) / sizeof ( *functions );
+}
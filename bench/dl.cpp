@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "dl"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static void* load ( const char* path ) {
+    void* handle = dl::open ( path );
+    if ( !handle ) {
+        std::fprintf ( stderr, "cannot open %s: %s\n", path, dl::error() );
+        std::exit ( 1 );
+    }
+    return handle;
+}
+
+/* names of the symbols exported by the plugins, see plugin.c */
+static std::vector<std::string> plugin_symbols ( int digits, int count ) {
+    std::vector<std::string> names;
+    for ( int i = 0; i < count; i++ ) {
+        char name[32];
+        std::snprintf ( name, sizeof ( name ), "plugin_sym_%0*x", digits, i );
+        names.push_back ( name );
+    }
+    return names;
+}
+
+BENCHMARK("dl/open+close (16 symbols)") {
+    for ( int i = 0; i < 100; i++ )
+        dl::close ( load ( BENCH_PLUGIN_SMALL ) );
+    state.items = 100;
+}
+
+BENCHMARK("dl/open+close (1024 symbols)") {
+    for ( int i = 0; i < 100; i++ )
+        dl::close ( load ( BENCH_PLUGIN_LARGE ) );
+    state.items = 100;
+}
+
+BENCHMARK("dl/sym (1024 symbols)") {
+    static void* handle = load ( BENCH_PLUGIN_LARGE );
+    static std::vector<std::string> names = plugin_symbols ( 3, 1024 );
+    std::size_t found = 0;
+    for ( int round = 0; round < 10; round++ )
+        for ( auto&& name: names )
+            found += dl::sym ( handle, name.c_str() ) != nullptr;
+    if ( found != 10 * names.size() ) {
+        std::fprintf ( stderr, "dl::sym: %s\n", dl::error() );
+        std::exit ( 1 );
+    }
+    state.items = found;
+}
+
+BENCHMARK("dl/sym (missing)") {
+    static void* handle = load ( BENCH_PLUGIN_LARGE );
+    std::size_t found = 0;
+    for ( int i = 0; i < 10000; i++ )
+        found += dl::sym ( handle, "plugin_missing" ) != nullptr;
+    bench::keep ( found );
+    state.items = 10000;
+}
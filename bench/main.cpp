@@ -0,0 +1,289 @@
+/*
+ * Benchmark runner
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+struct benchmark {
+    std::string name;
+    bench::function fn;
+};
+
+std::vector<benchmark>& registry() {
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+std::atomic<std::size_t> allocations{0};
+std::atomic<std::size_t> allocated_bytes{0};
+
+struct temp_files {
+    std::vector<std::string> paths;
+    ~temp_files() {
+        for ( auto&& path: paths )
+            std::remove ( path.c_str() );
+    }
+};
+
+temp_files& scratch() {
+    static temp_files files;
+    return files;
+}
+
+struct result {
+    std::string name;
+    bench::state state;
+    std::vector<double> ns;
+    double allocations;
+    double allocated_bytes;
+    nonstd_stats stats;
+
+    /* a percentile needs enough samples not to collapse into the maximum: 10 for p90, 100 for p99 */
+    bool has_percentile ( double p ) const {
+        return ns.size() * ( 100 - p ) >= 100;
+    }
+
+    /* nearest rank */
+    double percentile ( double p ) const {
+        std::size_t rank = std::ceil ( p * ns.size() / 100 );
+        return ns[std::max<std::size_t> ( rank, 1 ) - 1];
+    }
+
+    double mean() const {
+        double sum = 0;
+        for ( double t: ns )
+            sum += t;
+        return sum / ns.size();
+    }
+};
+
+std::string json_percentile ( const result& r, double p ) {
+    if ( !r.has_percentile ( p ) )
+        return "null";
+    std::ostringstream out;
+    out.precision ( 12 );
+    out << r.percentile ( p );
+    return out.str();
+}
+
+std::string table_percentile ( const result& r, double p ) {
+    if ( !r.has_percentile ( p ) )
+        return "-";
+    char s[32];
+    std::snprintf ( s, sizeof ( s ), "%.3fms", r.percentile ( p ) / 1e6 );
+    return s;
+}
+
+std::string json_string ( const std::string& s ) {
+    std::string r = "\"";
+    for ( char c: s ) {
+        if ( c == '"' || c == '\\' )
+            r += '\\';
+        r += c;
+    }
+    return r + '"';
+}
+
+void write_json ( std::ostream& out, const std::vector<result>& results, int iterations ) {
+    char date[32];
+    std::time_t now = std::time ( nullptr );
+    std::strftime ( date, sizeof ( date ), "%Y-%m-%dT%H:%M:%SZ", std::gmtime ( &now ) );
+    out.precision ( 12 );
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+#ifdef __VERSION__
+        << "    \"compiler\": " << json_string ( __VERSION__ ) << ",\n"
+#endif
+        << "    \"cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"iterations\": " << iterations << ",\n"
+#ifdef __GLIBC__
+        << "    \"allocation_tracking\": true\n"
+#else
+        << "    \"allocation_tracking\": false\n"
+#endif
+        << "  },\n  \"benchmarks\": [";
+    for ( std::size_t i = 0; i < results.size(); i++ ) {
+        const result& r = results[i];
+        double seconds = r.mean() / 1e9;
+        out << ( i ? "," : "" ) << "\n    {\n"
+            << "      \"name\": " << json_string ( r.name ) << ",\n"
+            << "      \"bytes_per_iteration\": " << r.state.bytes << ",\n"
+            << "      \"items_per_iteration\": " << r.state.items << ",\n"
+            << "      \"mean_ns\": " << r.mean() << ",\n"
+            << "      \"min_ns\": " << r.ns.front() << ",\n"
+            << "      \"p50_ns\": " << r.percentile ( 50 ) << ",\n"
+            << "      \"p90_ns\": " << json_percentile ( r, 90 ) << ",\n"
+            << "      \"p99_ns\": " << json_percentile ( r, 99 ) << ",\n"
+            << "      \"max_ns\": " << r.ns.back() << ",\n"
+            << "      \"bytes_per_second\": " << r.state.bytes / seconds << ",\n"
+            << "      \"items_per_second\": " << r.state.items / seconds << ",\n"
+            << "      \"allocations\": " << r.allocations << ",\n"
+            << "      \"allocated_bytes\": " << r.allocated_bytes;
+#ifdef NONSTD_STATS
+        out << ",\n      \"stats\": {"
+            << " \"bytes_decoded\": " << r.stats.bytes_decoded
+            << ", \"invalid_sequences\": " << r.stats.invalid_sequences
+            << ", \"refills\": " << r.stats.refills
+            << ", \"refill_bytes\": " << r.stats.refill_bytes
+            << ", \"underruns\": " << r.stats.underruns
+            << ", \"allocations\": " << r.stats.allocations
+            << ", \"reallocations\": " << r.stats.reallocations << " }";
+#endif
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void usage ( const char* argv0 ) {
+    std::fprintf ( stderr, "usage: %s [--list] [--filter SUBSTRING] [--iterations N] [--json FILE]\n"
+                           "p90 is reported from 10 iterations on (the default is 20), p99 from 100\n", argv0 );
+}
+}
+
+void bench::add ( std::string name, function fn ) {
+    registry().push_back ( { std::move ( name ), std::move ( fn ) } );
+}
+
+std::string bench::temp_file ( const std::string& name ) {
+#ifdef _WIN32
+    const char* dir = std::getenv ( "TEMP" );
+    std::string path = std::string ( dir ? dir : "." ) + "\\nonstdc++-bench-" + name;
+#else
+    const char* dir = std::getenv ( "TMPDIR" );
+    std::string path = std::string ( dir ? dir : "/tmp" ) + "/nonstdc++-bench-" + std::to_string ( getpid() ) + "-" + name;
+#endif
+    scratch().paths.push_back ( path );
+    return path;
+}
+
+#ifdef __GLIBC__
+/* count every allocation, including those made inside the libraries */
+extern "C" {
+void* __libc_malloc ( std::size_t size );
+void* __libc_calloc ( std::size_t n, std::size_t size );
+void* __libc_realloc ( void* p, std::size_t size );
+
+void* malloc ( std::size_t size ) {
+    allocations.fetch_add ( 1, std::memory_order_relaxed );
+    allocated_bytes.fetch_add ( size, std::memory_order_relaxed );
+    return __libc_malloc ( size );
+}
+
+void* calloc ( std::size_t n, std::size_t size ) {
+    allocations.fetch_add ( 1, std::memory_order_relaxed );
+    allocated_bytes.fetch_add ( n * size, std::memory_order_relaxed );
+    return __libc_calloc ( n, size );
+}
+
+void* realloc ( void* p, std::size_t size ) {
+    allocations.fetch_add ( 1, std::memory_order_relaxed );
+    allocated_bytes.fetch_add ( size, std::memory_order_relaxed );
+    return __libc_realloc ( p, size );
+}
+}
+#endif
+
+int main ( int argc, char** argv ) {
+    const char* filter = "";
+    const char* json = nullptr;
+    int iterations = 20;
+    for ( int i = 1; i < argc; i++ ) {
+        if ( !std::strcmp ( argv[i], "--list" ) ) {
+            for ( auto&& b: registry() )
+                std::puts ( b.name.c_str() );
+            return 0;
+        }
+        else if ( !std::strcmp ( argv[i], "--filter" ) && i + 1 < argc )
+            filter = argv[++i];
+        else if ( !std::strcmp ( argv[i], "--iterations" ) && i + 1 < argc )
+            iterations = std::max ( 1, std::atoi ( argv[++i] ) );
+        else if ( !std::strcmp ( argv[i], "--json" ) && i + 1 < argc )
+            json = argv[++i];
+        else {
+            usage ( argv[0] );
+            return 2;
+        }
+    }
+
+    std::vector<result> results;
+    std::printf ( "%-52s %12s %12s %12s %12s %12s %10s\n", "benchmark", "p50", "p90", "p99", "MB/s", "Mitems/s", "allocs" );
+    for ( auto&& b: registry() ) {
+        if ( b.name.find ( filter ) == std::string::npos )
+            continue;
+        result r{b.name, {}, {}, 0, 0, {}};
+        b.fn ( r.state );
+        nonstd_stats before;
+        nonstd_stats_snapshot ( &before );
+        std::size_t allocs = 0, bytes = 0;
+        for ( int i = 0; i < iterations; i++ ) {
+            r.state = {};
+            std::size_t a = allocations, ab = allocated_bytes;
+            auto start = std::chrono::steady_clock::now();
+            b.fn ( r.state );
+            auto end = std::chrono::steady_clock::now();
+            allocs += allocations - a;
+            bytes += allocated_bytes - ab;
+            r.ns.push_back ( std::chrono::duration<double, std::nano> ( end - start ).count() );
+        }
+        nonstd_stats_snapshot ( &r.stats );
+        /* per iteration, like the allocation counts */
+        uint64_t* counters = reinterpret_cast<uint64_t*> ( &r.stats );
+        const uint64_t* start = reinterpret_cast<const uint64_t*> ( &before );
+        for ( std::size_t i = 0; i < sizeof ( nonstd_stats ) / sizeof ( uint64_t ); i++ )
+            counters[i] = ( counters[i] - start[i] ) / iterations;
+        std::sort ( r.ns.begin(), r.ns.end() );
+        r.allocations = double ( allocs ) / iterations;
+        r.allocated_bytes = double ( bytes ) / iterations;
+        double seconds = r.mean() / 1e9;
+        std::printf ( "%-52s %10.3fms %12s %12s %12.1f %12.2f %10.1f\n", r.name.c_str(),
+                      r.percentile ( 50 ) / 1e6, table_percentile ( r, 90 ).c_str(), table_percentile ( r, 99 ).c_str(),
+                      r.state.bytes / seconds / 1e6, r.state.items / seconds / 1e6, r.allocations );
+        results.push_back ( std::move ( r ) );
+    }
+
+    if ( json ) {
+        std::ofstream out ( json );
+        write_json ( out, results, iterations );
+        if ( !out ) {
+            std::fprintf ( stderr, "cannot write %s\n", json );
+            return 1;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+/*
+ * Synthetic plugin for the dl benchmarks
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* PLUGIN_SYMBOLS functions called plugin_sym_<hex index> */
+
+#define SYM(n) int plugin_sym_##n ( void ) { return 0x##n; }
+#define SYM16(p) SYM(p##0) SYM(p##1) SYM(p##2) SYM(p##3) SYM(p##4) SYM(p##5) SYM(p##6) SYM(p##7) \
+                 SYM(p##8) SYM(p##9) SYM(p##a) SYM(p##b) SYM(p##c) SYM(p##d) SYM(p##e) SYM(p##f)
+#define SYM256(p) SYM16(p##0) SYM16(p##1) SYM16(p##2) SYM16(p##3) SYM16(p##4) SYM16(p##5) SYM16(p##6) SYM16(p##7) \
+                  SYM16(p##8) SYM16(p##9) SYM16(p##a) SYM16(p##b) SYM16(p##c) SYM16(p##d) SYM16(p##e) SYM16(p##f)
+
+#if PLUGIN_SYMBOLS == 16
+SYM16(0)
+#elif PLUGIN_SYMBOLS == 1024
+SYM256(0) SYM256(1) SYM256(2) SYM256(3)
+#else
+#error "unsupported PLUGIN_SYMBOLS"
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "bench.h"
+#include "power"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/* the recursive implementation power used to have */
+template <typename Tp, typename Int, typename Op = std::multiplies<Tp>>
+static Tp recursive_power(Tp x, Int n, Op op = {}) {
+    switch (n) {
+        case 0:
+            return non_std::identity_element(op);
+        case 1:
+            return x;
+        case 2:
+            return op(x, x);
+    }
+    if (n < 0)
+        return recursive_power(non_std::inverse_element(op)(x), -n, op);
+    if (n % 2)
+        return op(recursive_power(recursive_power(x, n/2, op), 2, op), x);
+    return recursive_power(recursive_power(x, n/2, op), 2, op);
+}
+
+static const std::vector<double>& bases() {
+    static std::vector<double> xs = [] {
+        std::vector<double> xs(1 << 20);
+        for (std::size_t i = 0; i < xs.size(); i++)
+            xs[i] = 1.0 + i * 1e-7;
+        return xs;
+    }();
+    return xs;
+}
+
+static volatile int exponent = 15;
+
+template <typename F>
+static void each(bench::state& state, F f) {
+    double sum = 0;
+    for (double x : bases())
+        sum += f(x);
+    bench::keep(sum);
+    state.items = bases().size();
+}
+
+BENCHMARK("power/std::pow") {
+    int n = exponent;
+    each(state, [n] (double x) { return std::pow(x, n); });
+}
+
+BENCHMARK("power/recursive") {
+    int n = exponent;
+    each(state, [n] (double x) { return recursive_power(x, n); });
+}
+
+BENCHMARK("power/runtime") {
+    int n = exponent;
+    each(state, [n] (double x) { return non_std::power(x, n); });
+}
+
+BENCHMARK("power/compile-time<15>") {
+    each(state, [] (double x) { return non_std::power<15>(x); });
+}
+
+BENCHMARK("power/batched") {
+    static std::vector<double> ys;
+    ys = bases();
+    non_std::power(ys.data(), ys.data() + ys.size(), int(exponent));
+    bench::keep(ys[0]);
+    state.items = ys.size();
+}
+
+BENCHMARK("power/modular") {
+    non_std::modular_multiplies<std::uint64_t> op{1000000007};
+    std::uint64_t sum = 0;
+    for (std::uint64_t x = 2; x < 100000; x++)
+        sum += non_std::power(x, 1000000005, op);
+    bench::keep(sum);
+    state.items = 100000 - 2;
+}
+
+BENCHMARK("power/matrix-fibonacci") {
+    using mod = non_std::modular_multiplies<std::uint64_t>;
+    using add = non_std::modular_plus<std::uint64_t>;
+    non_std::matrix_multiplies<std::uint64_t, 2, mod, add> op{{1000000007}, {1000000007}};
+    std::uint64_t sum = 0;
+    for (long long n = 1; n < 10000; n++)
+        sum += non_std::power(decltype(op)::matrix{{{1, 1}, {1, 0}}}, n * 1000003, op)[0][1];
+    bench::keep(sum);
+    state.items = 10000 - 1;
+}
+
+/* a user type with only * and *=, as big-integer and matrix classes usually have */
+struct matrix2 {
+    std::uint64_t a, b, c, d;
+
+    explicit matrix2(std::uint64_t x) : a(x), b(0), c(0), d(x) {}
+    matrix2(std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t d) : a(a), b(b), c(c), d(d) {}
+
+    matrix2& operator*=(const matrix2& y) {
+        return *this = *this * y;
+    }
+
+    friend matrix2 operator*(const matrix2& x, const matrix2& y) {
+        return {x.a * y.a + x.b * y.c, x.a * y.b + x.b * y.d,
+                x.c * y.a + x.d * y.c, x.c * y.b + x.d * y.d};
+    }
+};
+
+BENCHMARK("power/user-matrix") {
+    std::uint64_t sum = 0;
+    for (unsigned n = 1; n < 10000; n++)
+        sum += non_std::power(matrix2{1, 1, 1, 0}, n * 1000003u).b;
+    bench::keep(sum);
+    state.items = 10000 - 1;
+}
@@ -23,6 +23,13 @@
 #include <stdint.h>
 #include <stdio.h>
 
+/* byte order of UTF-16 data */
+#define UTF_NATIVE_ENDIAN 0
+#define UTF_LITTLE_ENDIAN 1
+#define UTF_BIG_ENDIAN 2
+/* use the BOM if present, else native; when writing, prepend a native BOM */
+#define UTF_DETECT_BOM 3
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -37,6 +44,17 @@ size_t utf8_strlen ( const char* s );
 uint_least32_t* utf8_to_utf32 ( const char* src, uint_least32_t* dst, size_t len );
 uint_least16_t* utf8_to_utf16 ( const char* src, uint_least16_t* dst, size_t len );
 
+/*
+ * Split src into chunks at code point boundaries and transcode them on
+ * separate threads. size is in bytes (0 means strlen), threads 0 means
+ * one per online CPU. dst must hold the whole output plus terminator.
+ */
+uint_least32_t* utf8_to_utf32_parallel ( const char* src, uint_least32_t* dst, size_t size, unsigned threads );
+uint_least16_t* utf8_to_utf16_parallel ( const char* src, uint_least16_t* dst, size_t size, unsigned threads );
+
+uint_least32_t* utf16_to_utf32 ( const uint_least16_t* src, uint_least32_t* dst, size_t len, int byte_order );
+uint_least16_t* utf32_to_utf16 ( const uint_least32_t* src, uint_least16_t* dst, size_t len, int byte_order );
+
 #ifdef __cplusplus
 }
 #endif
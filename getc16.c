@@ -22,9 +22,9 @@
 uint_least16_t getc16 ( FILE* stream ) {
     static uint_least16_t trail = 0;
     uint_least32_t c = trail ? trail : getc32(stream);
-    if (U16_LENGTH(c) == 2) {
-        trail = U16_TRAIL(c);
-        c = U16_LEAD(c);
+    if (NONSTD_U16_LENGTH(c) == 2) {
+        trail = NONSTD_U16_TRAIL(c);
+        c = NONSTD_U16_LEAD(c);
     }
     return c;
 }
@@ -17,9 +17,9 @@
  */
 
 #include "char32.h"
+#include "stats.h"
 #include "unicode/utf8.h"
 
-uint8_t _c8len ( char c );
 uint_least32_t getc32 ( FILE* stream ) {
     uint_least32_t _c;
     uint8_t len;
@@ -27,19 +27,30 @@ uint_least32_t getc32 ( FILE* stream ) {
         int c = getc(stream);
         if ( c == EOF )
             return -1;
-        if (U8_IS_SINGLE(c))
+        if (NONSTD_U8_IS_SINGLE(c)) {
+            NONSTD_STATS_ADD(bytes_decoded, 1);
             return c;
-        len = _c8len(c);
-        if (len == 1)
+        }
+        len = nonstd_u8_length(c);
+        if (len == 1) {
+            NONSTD_STATS_ADD(invalid_sequences, 1);
             return -1;
+        }
         _c = c & (0xfe >> len);
     }
     for (int i = 1; i < len; i++) {
         int c = getc(stream);
-        if (!U8_IS_TRAIL(c))
+        if (!NONSTD_U8_IS_TRAIL(c)) {
+            NONSTD_STATS_ADD(invalid_sequences, 1);
             return -1;
+        }
         _c <<= 6;
         _c |= (c & 0x3f);
     }
+    if (!nonstd_u8_is_valid(_c, len)) {
+        NONSTD_STATS_ADD(invalid_sequences, 1);
+        return -1;
+    }
+    NONSTD_STATS_ADD(bytes_decoded, len);
     return _c;
 }
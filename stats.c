@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "stats.h"
+
+#define COUNTERS (sizeof(struct nonstd_stats) / sizeof(uint64_t))
+
+/*
+ * Each thread counts into its own cache line. Blocks of exited threads
+ * are handed to new threads instead of being freed, so their counts
+ * stay in the totals.
+ */
+struct block {
+    alignas(64) _Atomic uint64_t counters[COUNTERS];
+    struct block* next;
+    bool retired;
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t once = PTHREAD_ONCE_INIT;
+static pthread_key_t key;
+static struct block* blocks;
+static _Thread_local struct block* local;
+
+/* runs on the exiting thread; a later count from another destructor attaches again */
+static void detach ( void* b ) {
+    local = NULL;
+    pthread_mutex_lock(&lock);
+    ((struct block*)b)->retired = true;
+    pthread_mutex_unlock(&lock);
+}
+
+static void create_key ( void ) {
+    pthread_key_create(&key, detach);
+}
+
+static struct block* attach ( void ) {
+    pthread_once(&once, create_key);
+    pthread_mutex_lock(&lock);
+    struct block* b = blocks;
+    while (b && !b->retired)
+        b = b->next;
+    if (b)
+        b->retired = false;
+    else if ((b = aligned_alloc(alignof(struct block), sizeof(struct block)))) {
+        for (size_t i = 0; i < COUNTERS; i++)
+            atomic_init(&b->counters[i], 0);
+        b->retired = false;
+        b->next = blocks;
+        blocks = b;
+    }
+    pthread_mutex_unlock(&lock);
+    if (b)
+        pthread_setspecific(key, b);
+    return local = b;
+}
+
+void _nonstd_stats_add ( unsigned counter, uint64_t n ) {
+    struct block* b = local ? local : attach();
+    if (!b)
+        return;
+    /* only this thread writes to its block */
+    uint64_t value = atomic_load_explicit(&b->counters[counter], memory_order_relaxed);
+    atomic_store_explicit(&b->counters[counter], value + n, memory_order_relaxed);
+}
+
+void nonstd_stats_snapshot ( struct nonstd_stats* stats ) {
+    uint64_t sum[COUNTERS] = {0};
+    pthread_mutex_lock(&lock);
+    for (struct block* b = blocks; b; b = b->next)
+        for (size_t i = 0; i < COUNTERS; i++)
+            sum[i] += atomic_load_explicit(&b->counters[i], memory_order_relaxed);
+    pthread_mutex_unlock(&lock);
+    memcpy(stats, sum, sizeof(*stats));
+}
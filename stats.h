@@ -0,0 +1,68 @@
+/*
+ * Hot-path instrumentation counters
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _NONSTD_STATS_H
+#define _NONSTD_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Counters are only kept when the libraries are built with NONSTD_STATS
+ * (cmake -DSTATS=ON); otherwise every snapshot is all zeros.
+ */
+struct nonstd_stats {
+    uint64_t bytes_decoded;       /* input consumed by getc32 and the converters */
+    uint64_t invalid_sequences;   /* inputs rejected as invalid */
+    uint64_t refills;             /* basic_buffered_ifstream buffer refills */
+    uint64_t refill_bytes;
+    uint64_t underruns;           /* refills that found nothing buffered and had to wait */
+    uint64_t allocations;         /* output buffers allocated by the converters */
+    uint64_t reallocations;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef NONSTD_STATS
+
+/* sum of the counters of every thread that ever counted anything */
+void nonstd_stats_snapshot ( struct nonstd_stats* stats );
+
+void _nonstd_stats_add ( unsigned counter, uint64_t n );
+#define NONSTD_STATS_ADD(counter, n) \
+    _nonstd_stats_add(offsetof(struct nonstd_stats, counter) / sizeof(uint64_t), (n))
+
+#else
+
+static inline void nonstd_stats_snapshot ( struct nonstd_stats* stats ) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+#define NONSTD_STATS_ADD(counter, n) ((void)sizeof(n))
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _NONSTD_STATS_H
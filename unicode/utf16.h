@@ -1,10 +1,38 @@
+#ifndef _NONSTD_UNICODE_UTF16_H
+#define _NONSTD_UNICODE_UTF16_H
+
+#include <stdbool.h>
 #include <stdint.h>
+#include "../char32.h"
+
+#define NONSTD_U16_IS_LEAD(c) (((c)&0xfffffc00)==0xd800)
+#define NONSTD_U16_IS_TRAIL(c) (((c)&0xfffffc00)==0xdc00)
+#define NONSTD_U16_SURROGATE_OFFSET ((0xd800<<10UL)+0xdc00-0x10000)
+#define NONSTD_U16_GET_SUPPLEMENTARY(lead, trail) \
+    (((uint_least32_t)(lead)<<10UL)+(uint_least32_t)(trail)-NONSTD_U16_SURROGATE_OFFSET)
+#define NONSTD_U16_LEAD(supplementary) (uint_least16_t)(((supplementary)>>10)+0xd7c0)
+#define NONSTD_U16_TRAIL(supplementary) (uint_least16_t)(((supplementary)&0x3ff)|0xdc00)
+#define NONSTD_U16_LENGTH(c) ((uint32_t)(c)<=0xffff ? 1 : 2)
+#define NONSTD_U16_BSWAP(c) (uint_least16_t)((c) << 8 | (c) >> 8)
+
+/* encode c into c16 without a terminator; returns units written */
+static inline uint8_t nonstd_u16_encode ( uint_least32_t c, uint_least16_t* c16 ) {
+    if (NONSTD_U16_LENGTH(c) == 1) {
+        c16[0] = c;
+        return 1;
+    }
+    c16[0] = NONSTD_U16_LEAD(c);
+    c16[1] = NONSTD_U16_TRAIL(c);
+    return 2;
+}
+
+/* whether UTF-16 in byte_order, one of the UTF_* constants, has to be byte swapped here */
+static inline bool nonstd_u16_swap ( int byte_order ) {
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return byte_order == UTF_LITTLE_ENDIAN;
+#else
+    return byte_order == UTF_BIG_ENDIAN;
+#endif
+}
 
-#define U16_IS_LEAD(c) (((c)&0xfffffc00)==0xd800)
-#define U16_IS_TRAIL(c) (((c)&0xfffffc00)==0xdc00)
-#define U16_SURROGATE_OFFSET ((0xd800<<10UL)+0xdc00-0x10000)
-#define U16_GET_SUPPLEMENTARY(lead, trail) \
-    (((uint_least32_t)(lead)<<10UL)+(uint_least32_t)(trail)-U16_SURROGATE_OFFSET)
-#define U16_LEAD(supplementary) (uint_least8_t)(((supplementary)>>10)+0xd7c0)
-#define U16_TRAIL(supplementary) (uint_least8_t)(((supplementary)&0x3ff)|0xdc00)
-#define U16_LENGTH(c) ((uint32_t)(c)<=0xffff ? 1 : 2)
+#endif // _NONSTD_UNICODE_UTF16_H
@@ -1,5 +1,75 @@
+#ifndef _NONSTD_UNICODE_UTF8_H
+#define _NONSTD_UNICODE_UTF8_H
+
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-#define U8_IS_SINGLE(c) (((c)&0x80)==0)
-#define U8_IS_LEAD(c) ((uint8_t)((c)-0xc2)<=0x32)
-#define U8_IS_TRAIL(c) ((int8_t)(c)<-0x40)
+#define NONSTD_U8_IS_SINGLE(c) (((c)&0x80)==0)
+#define NONSTD_U8_IS_LEAD(c) ((uint8_t)((c)-0xc2)<=0x32)
+#define NONSTD_U8_IS_TRAIL(c) ((int8_t)(c)<-0x40)
+
+/* length of the sequence started by c, 1 for anything but a lead byte */
+static inline uint8_t nonstd_u8_length ( char c ) {
+    if (!NONSTD_U8_IS_LEAD(c))
+        return 1;
+    uint8_t len = 1;
+    while ((uint8_t)c >= (uint8_t)(0xff << (7 - len)))
+        len++;
+    return len;
+}
+
+/* whether a len-byte sequence may encode c: not overlong, not a surrogate, at most U+10FFFF */
+static inline bool nonstd_u8_is_valid ( uint_least32_t c, uint8_t len ) {
+    static const uint_least32_t min[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    return c >= min[len] && c <= 0x10ffff && (c & 0xfffff800) != 0xd800;
+}
+
+/* decode one code point from at most avail bytes; returns bytes used, 0 if invalid */
+static inline uint8_t nonstd_u8_decode ( const char* src, size_t avail, uint_least32_t* c ) {
+    if (NONSTD_U8_IS_SINGLE(*src)) {
+        *c = *src;
+        return 1;
+    }
+    uint8_t len = nonstd_u8_length(*src);
+    if (len == 1 || len > avail)
+        return 0;
+    uint_least32_t _c = *src & (0xfe >> len);
+    for (int i = 1; i < len; i++) {
+        if (!NONSTD_U8_IS_TRAIL(src[i]))
+            return 0;
+        _c <<= 6;
+        _c |= (src[i] & 0x3f);
+    }
+    if (!nonstd_u8_is_valid(_c, len))
+        return 0;
+    *c = _c;
+    return len;
+}
+
+/* encode c into c8 without a terminator; returns bytes written */
+static inline uint8_t nonstd_u8_encode ( uint_least32_t c, char* c8 ) {
+    if (c < 0x80) {
+        c8[0] = c;
+        return 1;
+    }
+    uint8_t len;
+    if (c < 0x800)
+        len = 2;
+    else if (c < 0x10000)
+        len = 3;
+    else if (c < 0x200000)
+        len = 4;
+    else if (c < 0x4000000)
+        len = 5;
+    else
+        len = 6;
+    for (int i = len - 1; i >= 0; i--) {
+        c8[i] = 0x80 | (c & 0x3f);
+        c >>= 6;
+    }
+    c8[0] |= 0xff << (8 - len);
+    return len;
+}
+
+#endif // _NONSTD_UNICODE_UTF8_H
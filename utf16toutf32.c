@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <malloc.h>
+#include <stdbool.h>
+#include "char32.h"
+#include "stats.h"
+#include "unicode/utf16.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+uint_least32_t* utf16_to_utf32 ( const uint_least16_t* src, uint_least32_t* dst, size_t len, int byte_order ) {
+    if (!len)
+        while (src[len])
+            len++;
+    if (byte_order == UTF_DETECT_BOM) {
+        byte_order = UTF_NATIVE_ENDIAN;
+        if (len && (src[0] == 0xfeff || src[0] == 0xfffe)) {
+            if (src[0] == 0xfffe)
+                byte_order = nonstd_u16_swap(UTF_BIG_ENDIAN) ? UTF_BIG_ENDIAN : UTF_LITTLE_ENDIAN;
+            src++;
+            len--;
+        }
+    }
+    bool swap = nonstd_u16_swap(byte_order);
+    bool alloc = !dst;
+    if (alloc) {
+        dst = malloc(len * 4 + 4);
+        NONSTD_STATS_ADD(allocations, 1);
+    }
+    if (!dst)
+        return NULL;
+    size_t i = 0, j = 0;
+    while (i < len) {
+#ifdef __SSE2__
+        /* convert 8 units at once, pairing surrogates in vector registers */
+        while (len - i >= 8) {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i c = _mm_loadu_si128((const __m128i*)(src + i));
+            if (swap)
+                c = _mm_or_si128(_mm_slli_epi16(c, 8), _mm_srli_epi16(c, 8));
+            __m128i high = _mm_and_si128(c, _mm_set1_epi16((short)0xfc00));
+            __m128i leads = _mm_cmpeq_epi16(high, _mm_set1_epi16((short)0xd800));
+            __m128i trails = _mm_cmpeq_epi16(high, _mm_set1_epi16((short)0xdc00));
+            unsigned lead_mask = _mm_movemask_epi8(_mm_packs_epi16(leads, zero));
+            unsigned trail_mask = _mm_movemask_epi8(_mm_packs_epi16(trails, zero));
+            __m128i lo = _mm_unpacklo_epi16(c, zero);
+            __m128i hi = _mm_unpackhi_epi16(c, zero);
+            if (!(lead_mask | trail_mask)) {
+                _mm_storeu_si128((__m128i*)(dst + j), lo);
+                _mm_storeu_si128((__m128i*)(dst + j + 4), hi);
+                i += 8;
+                j += 8;
+                continue;
+            }
+            /* a lead in the last lane is paired in the next block */
+            unsigned n = 8;
+            if (lead_mask & 0x80) {
+                lead_mask &= 0x7f;
+                n = 7;
+            }
+            /* unpaired surrogates are left to the scalar loop to report */
+            if (trail_mask != lead_mask << 1)
+                break;
+            __m128i next = _mm_srli_si128(c, 2);
+            __m128i offset = _mm_set1_epi32(NONSTD_U16_SURROGATE_OFFSET);
+            __m128i pair_lo = _mm_add_epi32(_mm_slli_epi32(lo, 10), _mm_sub_epi32(_mm_unpacklo_epi16(next, zero), offset));
+            __m128i pair_hi = _mm_add_epi32(_mm_slli_epi32(hi, 10), _mm_sub_epi32(_mm_unpackhi_epi16(next, zero), offset));
+            __m128i lead_lo = _mm_unpacklo_epi16(leads, leads);
+            __m128i lead_hi = _mm_unpackhi_epi16(leads, leads);
+            uint32_t out[8];
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(_mm_and_si128(lead_lo, pair_lo), _mm_andnot_si128(lead_lo, lo)));
+            _mm_storeu_si128((__m128i*)(out + 4), _mm_or_si128(_mm_and_si128(lead_hi, pair_hi), _mm_andnot_si128(lead_hi, hi)));
+            /* drop the trail lanes */
+            for (unsigned k = 0; k < n; k++)
+                if (!(trail_mask >> k & 1))
+                    dst[j++] = out[k];
+            i += n;
+        }
+        if (i == len)
+            break;
+#endif
+        uint_least16_t c = swap ? NONSTD_U16_BSWAP(src[i]) : src[i];
+        i++;
+        if (NONSTD_U16_IS_LEAD(c) && i < len) {
+            uint_least16_t trail = swap ? NONSTD_U16_BSWAP(src[i]) : src[i];
+            if (NONSTD_U16_IS_TRAIL(trail)) {
+                dst[j++] = NONSTD_U16_GET_SUPPLEMENTARY(c, trail);
+                i++;
+                continue;
+            }
+        }
+        if (NONSTD_U16_IS_LEAD(c) || NONSTD_U16_IS_TRAIL(c)) {
+            NONSTD_STATS_ADD(invalid_sequences, 1);
+            if (alloc)
+                free(dst);
+            return NULL;
+        }
+        dst[j++] = c;
+    }
+    dst[j] = 0;
+    NONSTD_STATS_ADD(bytes_decoded, len * 2);
+    if (alloc) {
+        dst = realloc(dst, j * 4 + 4);
+        NONSTD_STATS_ADD(reallocations, 1);
+    }
+    return dst;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <malloc.h>
+#include <stdbool.h>
+#include "char32.h"
+#include "stats.h"
+#include "unicode/utf16.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+
+/* narrow 32-bit lanes holding values up to 0xffff; packs saturates signed values, so shift the range down and back */
+static inline __m128i pack16 ( __m128i lo, __m128i hi ) {
+    __m128i bias = _mm_set1_epi32(0x8000);
+    return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(lo, bias), _mm_sub_epi32(hi, bias)), _mm_set1_epi16((short)0x8000));
+}
+#endif
+
+uint_least16_t* utf32_to_utf16 ( const uint_least32_t* src, uint_least16_t* dst, size_t len, int byte_order ) {
+    if (!len)
+        while (src[len])
+            len++;
+    bool bom = byte_order == UTF_DETECT_BOM;
+    if (bom)
+        byte_order = UTF_NATIVE_ENDIAN;
+    bool swap = nonstd_u16_swap(byte_order);
+    bool alloc = !dst;
+    if (alloc) {
+        dst = malloc(len * 4 + 4);
+        NONSTD_STATS_ADD(allocations, 1);
+    }
+    if (!dst)
+        return NULL;
+    size_t i = 0, j = 0;
+    if (bom)
+        dst[j++] = swap ? NONSTD_U16_BSWAP(0xfeff) : 0xfeff;
+    while (i < len) {
+#ifdef __SSE2__
+        /* convert 8 code points at once, splitting surrogate pairs in vector registers */
+        while (len - i >= 8) {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 4));
+            __m128i planes_lo = _mm_srli_epi32(lo, 16);
+            __m128i planes_hi = _mm_srli_epi32(hi, 16);
+            __m128i invalid = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi32(_mm_and_si128(lo, _mm_set1_epi32((int)0xfffff800)), _mm_set1_epi32(0xd800)),
+                    _mm_cmpeq_epi32(_mm_and_si128(hi, _mm_set1_epi32((int)0xfffff800)), _mm_set1_epi32(0xd800))),
+                _mm_or_si128(
+                    _mm_cmpgt_epi32(planes_lo, _mm_set1_epi32(0x10)),
+                    _mm_cmpgt_epi32(planes_hi, _mm_set1_epi32(0x10))));
+            /* invalid code points are left to the scalar loop to report */
+            if (_mm_movemask_epi8(invalid))
+                break;
+            __m128i c = pack16(lo, hi);
+            if (swap)
+                c = _mm_or_si128(_mm_slli_epi16(c, 8), _mm_srli_epi16(c, 8));
+            unsigned wide_mask = _mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(
+                _mm_cmpgt_epi32(planes_lo, zero), _mm_cmpgt_epi32(planes_hi, zero)), zero));
+            if (!wide_mask) {
+                _mm_storeu_si128((__m128i*)(dst + j), c);
+                i += 8;
+                j += 8;
+                continue;
+            }
+            __m128i leads = pack16(
+                _mm_add_epi32(_mm_srli_epi32(lo, 10), _mm_set1_epi32(0xd7c0)),
+                _mm_add_epi32(_mm_srli_epi32(hi, 10), _mm_set1_epi32(0xd7c0)));
+            __m128i trails = pack16(
+                _mm_or_si128(_mm_and_si128(lo, _mm_set1_epi32(0x3ff)), _mm_set1_epi32(0xdc00)),
+                _mm_or_si128(_mm_and_si128(hi, _mm_set1_epi32(0x3ff)), _mm_set1_epi32(0xdc00)));
+            if (swap) {
+                leads = _mm_or_si128(_mm_slli_epi16(leads, 8), _mm_srli_epi16(leads, 8));
+                trails = _mm_or_si128(_mm_slli_epi16(trails, 8), _mm_srli_epi16(trails, 8));
+            }
+            uint16_t units[8], lead[8], trail[8];
+            _mm_storeu_si128((__m128i*)units, c);
+            _mm_storeu_si128((__m128i*)lead, leads);
+            _mm_storeu_si128((__m128i*)trail, trails);
+            /* widen the lanes holding supplementary code points into pairs */
+            for (unsigned k = 0; k < 8; k++) {
+                if (wide_mask >> k & 1) {
+                    dst[j++] = lead[k];
+                    dst[j++] = trail[k];
+                }
+                else
+                    dst[j++] = units[k];
+            }
+            i += 8;
+        }
+        if (i == len)
+            break;
+#endif
+        uint_least32_t c = src[i++];
+        if (c > 0x10ffff || NONSTD_U16_IS_LEAD(c) || NONSTD_U16_IS_TRAIL(c)) {
+            NONSTD_STATS_ADD(invalid_sequences, 1);
+            if (alloc)
+                free(dst);
+            return NULL;
+        }
+        if (NONSTD_U16_LENGTH(c) == 2) {
+            uint_least16_t lead = NONSTD_U16_LEAD(c);
+            dst[j++] = swap ? NONSTD_U16_BSWAP(lead) : lead;
+            c = NONSTD_U16_TRAIL(c);
+        }
+        dst[j++] = swap ? NONSTD_U16_BSWAP(c) : c;
+    }
+    dst[j] = 0;
+    NONSTD_STATS_ADD(bytes_decoded, len * 4);
+    if (alloc) {
+        dst = realloc(dst, j * 2 + 2);
+        NONSTD_STATS_ADD(reallocations, 1);
+    }
+    return dst;
+}
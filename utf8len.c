@@ -16,14 +16,12 @@
  *
  */
 
-#include <stddef.h>
-#include <stdint.h>
+#include "unicode/utf8.h"
 
-uint8_t _c8len ( char c );
 size_t utf8_strlen ( const char* s ) {
     size_t len = 0;
     while (*s) {
-        s += _c8len(*s);
+        s += nonstd_u8_length(*s);
         len++;
     }
     return len;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016  Matija Skala <mskala@gmx.com>
+ * Copyright (C) 2026  Matija Skala <mskala@gmx.com>
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -16,13 +16,9 @@
  *
  */
 
-#include "unicode/utf8.h"
+#include "char32.h"
+#include "_utf8parallel.h"
 
-uint8_t _c8len ( char c ) {
-    if (!U8_IS_LEAD(c))
-        return 1;
-    uint8_t len = 1;
-    while (c >= 0xff << (7 - len))
-        len++;
-    return len;
+uint_least16_t* utf8_to_utf16_parallel ( const char* src, uint_least16_t* dst, size_t size, unsigned threads ) {
+    return _utf8_parallel(src, dst, size, threads, 2);
 }
@@ -19,40 +19,29 @@
 #include <malloc.h>
 #include <stdbool.h>
 #include "char32.h"
+#include "stats.h"
 #include "unicode/utf8.h"
 
-uint8_t _c8len ( char c );
 uint_least32_t* utf8_to_utf32 ( const char* src, uint_least32_t* dst, size_t len ) {
     if (!len)
         len = utf8_strlen(src);
+    const char* begin = src;
     bool alloc = !dst;
-    if (alloc)
+    if (alloc) {
         dst = malloc(len * 4 + 4);
+        NONSTD_STATS_ADD(allocations, 1);
+    }
     for (size_t i = 0; i < len; i++) {
-        if (U8_IS_SINGLE(*src)) {
-            dst[i] = *(src++);
-            continue;
-        }
-        uint8_t len = _c8len(*src);
-        if (len == 1) {
+        uint8_t c8len = nonstd_u8_decode(src, SIZE_MAX, &dst[i]);
+        if (!c8len) {
+            NONSTD_STATS_ADD(invalid_sequences, 1);
             if (alloc)
                 free(dst);
             return NULL;
         }
-        uint_least32_t _c = *src & (0xfe >> len);
-        for (int j = 1; j < len; j++) {
-            int c = src[j];
-            if (!U8_IS_TRAIL(c)) {
-                if (alloc)
-                    free(dst);
-                return NULL;
-            }
-            _c <<= 6;
-            _c |= (c & 0x3f);
-        }
-        src += len;
-        dst[i] = _c;
+        src += c8len;
     }
     dst[len] = 0;
+    NONSTD_STATS_ADD(bytes_decoded, src - begin);
     return dst;
 }